@@ -0,0 +1,272 @@
+/*
+Auto-pipelining event loop (AutoPipeliner)
+    Producers push onto a Treiber stack (one CAS per request, no locks) and only
+    the producer that finds the stack empty writes a byte to the wake-up pipe.
+    The loop thread then:
+        takeQueued()   → swaps the whole stack out and restores FIFO order.
+        queueBatch()   → appends the batch to the unsent iovecs.
+        flushPending() → sends as much as the socket takes with one sendmsg(),
+                         keeping the rest for the next POLLOUT.
+        readReplies()  → one recv() into the read buffer, then completes the
+                         oldest fully sent request for each whole reply in it.
+*/
+
+#include "AutoPipeliner.h"
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#ifndef IOV_MAX
+#define IOV_MAX 1024
+#endif
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0 // SO_NOSIGPIPE is set on the socket instead
+#endif
+
+static const size_t READ_CHUNK = 64 * 1024;
+
+AutoPipeliner::AutoPipeliner(int sockfd)
+    : sockfd(sockfd), savedSockFlags(-1), wakeFds{-1, -1}, queueHead(&closedMarker),
+      activeSubmitters(0), running(false), fullyWritten(0) {}
+
+AutoPipeliner::~AutoPipeliner() {
+    stop();
+}
+
+bool AutoPipeliner::start() {
+    // A loop that already ran (even one that has since failed) is never restarted
+    if (loopThread.joinable()) return running;
+    if (pipe(wakeFds) != 0) {
+        perror("(Error) Failed to create wake-up pipe");
+        return false;
+    }
+    for (int fd : wakeFds) {
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+    }
+
+    // The loop must never block on a half-written request or a half-read reply
+    savedSockFlags = fcntl(sockfd, F_GETFL);
+    fcntl(sockfd, F_SETFL, savedSockFlags | O_NONBLOCK);
+#ifdef SO_NOSIGPIPE
+    int on = 1;
+    setsockopt(sockfd, SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+#endif
+
+    queueHead.store(nullptr);
+    running = true;
+    loopThread = std::thread(&AutoPipeliner::eventLoop, this);
+    return true;
+}
+
+void AutoPipeliner::stop() {
+    running = false;
+    if (loopThread.joinable()) {
+        wake();
+        loopThread.join();
+    }
+    failAll("(Error) Auto-pipelining stopped.");
+
+    // The queue is closed now; wait out submitters that may still be calling wake()
+    while (activeSubmitters.load() != 0) {
+        std::this_thread::yield();
+    }
+    for (int &fd : wakeFds) {
+        if (fd != -1) {
+            close(fd);
+            fd = -1;
+        }
+    }
+    if (savedSockFlags != -1) {
+        fcntl(sockfd, F_SETFL, savedSockFlags);
+        savedSockFlags = -1;
+    }
+}
+
+bool AutoPipeliner::isRunning() const {
+    return running;
+}
+
+std::string AutoPipeliner::submit(std::string command) {
+    std::unique_ptr<PendingRequest> request(new PendingRequest());
+    request->command = std::move(command);
+    std::future<std::string> reply = request->reply.get_future();
+
+    activeSubmitters.fetch_add(1);
+    PendingRequest *old = queueHead.load();
+    do {
+        if (old == &closedMarker) {
+            activeSubmitters.fetch_sub(1);
+            throw std::runtime_error("(Error) Auto-pipelining is not running.");
+        }
+        request->next = old;
+    } while (!queueHead.compare_exchange_weak(old, request.get()));
+    request.release(); // now owned by the event loop
+
+    // Only the first request of a batch needs to wake the loop
+    if (old == nullptr) wake();
+    activeSubmitters.fetch_sub(1);
+    return reply.get();
+}
+
+void AutoPipeliner::wake() {
+    char byte = 1;
+    // A full pipe already guarantees a pending wake-up, so EAGAIN is fine
+    ssize_t ignored = write(wakeFds[1], &byte, 1);
+    (void)ignored;
+}
+
+AutoPipeliner::PendingRequest *AutoPipeliner::takeQueued() {
+    PendingRequest *head = queueHead.exchange(nullptr);
+
+    // The stack is newest-first; reverse it so commands go out in submission order
+    PendingRequest *ordered = nullptr;
+    while (head) {
+        PendingRequest *next = head->next;
+        head->next = ordered;
+        ordered = head;
+        head = next;
+    }
+    return ordered;
+}
+
+void AutoPipeliner::eventLoop() {
+    struct pollfd fds[2];
+    fds[0].fd = wakeFds[0]; // new requests queued
+    fds[0].events = POLLIN;
+    fds[1].fd = sockfd;     // replies from Redis, and room to write
+    fds[1].events = POLLIN;
+
+    while (running) {
+        int ret = poll(fds, 2, -1);
+        if (ret < 0) {
+            if (errno == EINTR) continue;
+            failLoop("(Error) Poll failed.");
+            return;
+        }
+
+        // POLLHUP may still come with buffered replies, so let recv() report the close
+        if (fds[1].revents & (POLLIN | POLLHUP | POLLERR)) {
+            if (!readReplies()) {
+                failLoop("(Error) Redis connection lost.");
+                return;
+            }
+        }
+
+        if (fds[0].revents & POLLIN) {
+            char drain[64];
+            while (read(wakeFds[0], drain, sizeof(drain)) > 0) {}
+            queueBatch(takeQueued());
+        }
+
+        if (!pendingWrites.empty() && !flushPending()) {
+            failLoop("(Error) Failed to send command.");
+            return;
+        }
+        fds[1].events = pendingWrites.empty() ? POLLIN : (POLLIN | POLLOUT);
+    }
+}
+
+void AutoPipeliner::queueBatch(PendingRequest *batch) {
+    while (batch) {
+        PendingRequest *next = batch->next;
+        batch->next = nullptr;
+        pendingWrites.push_back({const_cast<char *>(batch->command.data()), batch->command.size()});
+        // Queue for a reply before writing so a failed write still fails the caller
+        inFlight.emplace_back(batch);
+        batch = next;
+    }
+}
+
+bool AutoPipeliner::flushPending() {
+    size_t pos = 0;
+    while (pos < pendingWrites.size()) {
+        struct msghdr msg;
+        std::memset(&msg, 0, sizeof(msg));
+        msg.msg_iov = &pendingWrites[pos];
+        msg.msg_iovlen = std::min(pendingWrites.size() - pos, (size_t)IOV_MAX);
+
+        ssize_t sent = sendmsg(sockfd, &msg, MSG_NOSIGNAL);
+        if (sent < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) break; // wait for POLLOUT
+            return false;
+        }
+
+        // Skip fully written buffers and trim a partially written one
+        while (pos < pendingWrites.size() && (size_t)sent >= pendingWrites[pos].iov_len) {
+            sent -= pendingWrites[pos].iov_len;
+            ++pos;
+            ++fullyWritten; // one iovec per request
+        }
+        if (pos < pendingWrites.size()) {
+            pendingWrites[pos].iov_base = static_cast<char *>(pendingWrites[pos].iov_base) + sent;
+            pendingWrites[pos].iov_len -= sent;
+        }
+    }
+    pendingWrites.erase(pendingWrites.begin(), pendingWrites.begin() + pos);
+    return true;
+}
+
+bool AutoPipeliner::readReplies() {
+    char chunk[READ_CHUNK];
+    ssize_t r = recv(sockfd, chunk, sizeof(chunk), 0);
+    if (r == 0) return false; // server closed the connection, possibly mid-reply
+    if (r < 0) return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+    readBuffer.append(chunk, r);
+
+    size_t pos = 0, end = 0;
+    std::string reply;
+    try {
+        // Scanning resumes where the last read stopped; strings are built only for whole replies
+        while (ResponseParser::scanBuffered(readBuffer, pos, replyScan, end)) {
+            // A reply before its request is fully sent (e.g. Redis rejecting an oversized
+            // bulk early) or one nobody asked for cannot be matched to a caller safely
+            if (fullyWritten == 0) return false;
+            ResponseParser::parseBuffered(readBuffer, pos, reply);
+            inFlight.front()->reply.set_value(std::move(reply));
+            inFlight.pop_front();
+            --fullyWritten;
+        }
+    } catch (const std::exception &) {
+        return false;
+    }
+    // Keep only the partial reply at the tail for the next tick
+    readBuffer.erase(0, pos);
+    return true;
+}
+
+void AutoPipeliner::failAll(const std::string &reason) {
+    std::exception_ptr error = std::make_exception_ptr(std::runtime_error(reason));
+
+    // Drop the iovecs first: they point into the requests' command buffers
+    pendingWrites.clear();
+    for (auto &request : inFlight) {
+        request->reply.set_exception(error);
+    }
+    inFlight.clear();
+    fullyWritten = 0;
+    readBuffer.clear();
+    replyScan = ResponseParser::ScanState();
+
+    // Close the queue so later submit() calls fail instead of waiting forever
+    PendingRequest *queued = queueHead.exchange(&closedMarker);
+    while (queued && queued != &closedMarker) {
+        std::unique_ptr<PendingRequest> request(queued);
+        queued = queued->next;
+        request->reply.set_exception(error);
+    }
+}
+
+// Fail everything and mark the loop dead before the loop thread exits on its own.
+void AutoPipeliner::failLoop(const std::string &reason) {
+    failAll(reason);
+    running = false;
+}
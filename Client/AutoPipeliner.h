@@ -0,0 +1,78 @@
+#ifndef AUTO_PIPELINER_H
+#define AUTO_PIPELINER_H
+
+#include <atomic>
+#include <deque>
+#include <future>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/uio.h>
+#include "ResponseParser.h"
+
+/*
+Auto-pipelining for a single Redis connection.
+    Commands submitted concurrently from any thread are pushed onto a lock-free
+    multi-producer stack. One event-loop thread owns the (non-blocking) socket: on
+    each tick it takes everything queued so far, sends it with a single sendmsg(),
+    and routes the replies back to the waiting callers in submission order.
+
+    There is no flush timer: the batch is whatever accumulated while the loop was
+    busy, so a lone request is written immediately and batches only grow under load.
+*/
+class AutoPipeliner {
+public:
+    explicit AutoPipeliner(int sockfd);
+    ~AutoPipeliner();
+
+    bool start();
+    void stop();
+    // False once stopped or once the loop has failed; a failed connection must be reopened
+    bool isRunning() const;
+
+    // Queue a RESP-encoded command and block until its reply arrives.
+    // Throws std::runtime_error if the connection fails before the full reply is read.
+    std::string submit(std::string command);
+
+private:
+    struct PendingRequest {
+        std::string command;
+        std::promise<std::string> reply;
+        PendingRequest *next = nullptr;
+    };
+
+    void eventLoop();
+    PendingRequest *takeQueued();
+    void queueBatch(PendingRequest *batch);
+    bool flushPending();
+    bool readReplies();
+    void failAll(const std::string &reason);
+    void failLoop(const std::string &reason);
+    void wake();
+
+    int sockfd;
+    int savedSockFlags;
+    int wakeFds[2];
+    // Queue head doubles as the open/closed state: &closedMarker means submit() must fail
+    PendingRequest closedMarker;
+    std::atomic<PendingRequest *> queueHead;
+    // Threads inside submit() that may still write to the wake-up pipe
+    std::atomic<int> activeSubmitters;
+    std::atomic<bool> running;
+    std::thread loopThread;
+
+    // Loop-thread state below
+    // Written (or partly written) requests awaiting a reply
+    std::deque<std::unique_ptr<PendingRequest>> inFlight;
+    // How many requests at the front of inFlight have been sent in full
+    size_t fullyWritten;
+    // Unsent command bytes; the buffers are owned by the inFlight requests
+    std::vector<struct iovec> pendingWrites;
+    // Received bytes not yet parsed into a complete reply
+    std::string readBuffer;
+    // How far the reply at the front of readBuffer has been scanned
+    ResponseParser::ScanState replyScan;
+};
+
+#endif //AUTO_PIPELINER_H
@@ -1,5 +1,6 @@
 #include "CLI.h"
 #include <vector>
+#include <algorithm>
 #include <poll.h>
 #include <readline/readline.h>
 #include <readline/history.h>
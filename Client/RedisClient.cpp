@@ -7,10 +7,15 @@ Establishing a TCP Connection to Redis (RedisClient)
         connectToServer() → Establishes the connection.
         sendCommand() → Sends a command over the socket.
         disconnect() → Closes the socket when finished.
+        enableAutoPipelining() → Hands the socket to an AutoPipeliner.
+        execute() → Sends a command and returns its parsed reply.
 */
 
 
 #include "RedisClient.h"
+#include "CommandHandler.h"
+#include "ResponseParser.h"
+#include <stdexcept>
 
 RedisClient::RedisClient(const std::string &host, int port) 
     : host(host), port(port), sockfd(-1) {}
@@ -52,6 +57,8 @@ bool RedisClient::connectToServer() {
 }
 
 void RedisClient::disconnect() {
+    // Stop the event loop before its socket goes away
+    pipeliner.reset();
     if (sockfd != -1) {
         close(sockfd); 
         sockfd = -1;  
@@ -63,7 +70,35 @@ int RedisClient::getSocketFD() const {
 }
 
 bool RedisClient::sendCommand(const std::string &command) {
-    if (sockfd == -1) return false;
+    // Raw writes would desynchronise the pipeliner's reply queue
+    if (sockfd == -1 || pipeliner) return false;
     ssize_t sent = send(sockfd, command.c_str(), command.size(), 0);
     return (sent == (ssize_t)command.size());
 }
+
+bool RedisClient::enableAutoPipelining() {
+    if (sockfd == -1) return false;
+    if (pipeliner) {
+        // A failed loop leaves the stream mid-reply; only a fresh connection can recover
+        if (pipeliner->isRunning()) return true;
+        pipeliner.reset();
+        return false;
+    }
+    pipeliner.reset(new AutoPipeliner(sockfd));
+    if (!pipeliner->start()) {
+        pipeliner.reset();
+        return false;
+    }
+    return true;
+}
+
+std::string RedisClient::execute(const std::vector<std::string> &args) {
+    std::string command = CommandHandler::buildRESPcommand(args);
+    if (pipeliner) {
+        return pipeliner->submit(std::move(command));
+    }
+    if (!sendCommand(command)) {
+        throw std::runtime_error("(Error) Failed to send command.");
+    }
+    return ResponseParser::parseResponse(sockfd);
+}
@@ -7,6 +7,9 @@
 #include <sys/socket.h>
 #include <unistd.h>
 #include <cstring>
+#include <memory>
+#include <vector>
+#include "AutoPipeliner.h"
 
 class RedisClient{
 public:
@@ -17,11 +20,20 @@ public:
     void disconnect();
     int getSocketFD() const;
     bool sendCommand(const std::string &command);
-    
+
+    // Route execute() through a shared event loop that batches concurrent commands.
+    // Returns false if an earlier loop failed: disconnect() and connectToServer() first.
+    bool enableAutoPipelining();
+    // Send a command and return its parsed reply; safe to call from many threads once
+    // auto-pipelining is enabled. Throws std::runtime_error on connection failure.
+    // disconnect() must not run while other threads may still be calling execute().
+    std::string execute(const std::vector<std::string> &args);
+
 private:
     std::string host;
     int port;
     int sockfd;
+    std::unique_ptr<AutoPipeliner> pipeliner;
 };
 
 #endif //REDIS_CLIENT_H
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include <cstdlib>
 #include <sys/types.h>
 #include <sys/socket.h>
+#include <stdexcept>
 
 // Function to read a single character from the socket.
 static bool readChar(int sockfd, char &c) {
@@ -98,3 +99,140 @@ std::string ResponseParser::parseArray(int sockfd) {
     }
     return oss.str();
 }
+
+// Read a CRLF-terminated line from the buffer; false if the terminator has not arrived yet.
+static bool bufferedLine(const std::string &buf, size_t &pos, std::string &line) {
+    size_t end = buf.find("\r\n", pos);
+    if (end == std::string::npos) return false;
+    line.assign(buf, pos, end - pos);
+    pos = end + 2;
+    return true;
+}
+
+// Parse a length or count field, rejecting anything that is not a plain integer.
+static long long bufferedLength(const std::string &field) {
+    size_t used = 0;
+    long long value = std::stoll(field, &used);
+    if (used != field.size()) {
+        throw std::runtime_error("Malformed length: " + field);
+    }
+    return value;
+}
+
+bool ResponseParser::parseBuffered(const std::string &buf, size_t &pos, std::string &reply) {
+    // Work on a copy of pos so an incomplete reply leaves the caller's offset untouched
+    size_t cur = pos;
+    if (cur >= buf.size()) return false;
+    char prefix = buf[cur++];
+
+    std::string line;
+    if (!bufferedLine(buf, cur, line)) return false;
+
+    switch (prefix) {
+        case '+' :
+        case ':' :
+            reply = line;
+            break;
+        case '-' :
+            reply = "(Error) " + line;
+            break;
+        case '$' : {
+            long long length = bufferedLength(line);
+            if (length == -1) {
+                reply = "(nil)";
+                break;
+            }
+            if (length < 0) throw std::runtime_error("Malformed bulk length.");
+            // Payload plus trailing CRLF must be buffered
+            if (buf.size() - cur < (size_t)length + 2) return false;
+            reply.assign(buf, cur, length);
+            cur += length + 2;
+            break;
+        }
+        case '*' : {
+            long long count = bufferedLength(line);
+            if (count == -1) {
+                reply = "(nil)";
+                break;
+            }
+            std::string joined, element;
+            for (long long i = 0; i < count; ++i) {
+                if (!parseBuffered(buf, cur, element)) return false;
+                joined += element;
+                if (i != count - 1) joined += "\n";
+            }
+            reply = joined;
+            break;
+        }
+        default:
+            throw std::runtime_error("Unknown reply type.");
+    }
+    pos = cur;
+    return true;
+}
+
+// Parse the length or count in buf[from, to) in place, without allocating.
+static long long scanLength(const std::string &buf, size_t from, size_t to) {
+    bool negative = from < to && buf[from] == '-';
+    if (negative) ++from;
+    if (from == to) throw std::runtime_error("Malformed length.");
+    long long value = 0;
+    for (size_t i = from; i < to; ++i) {
+        if (buf[i] < '0' || buf[i] > '9') throw std::runtime_error("Malformed length.");
+        value = value * 10 + (buf[i] - '0');
+    }
+    return negative ? -value : value;
+}
+
+bool ResponseParser::scanBuffered(const std::string &buf, size_t pos, ScanState &state, size_t &end) {
+    size_t cur = pos + state.offset;
+    while (true) {
+        // Stop at an element boundary so the next call can resume from here
+        state.offset = cur - pos;
+        if (cur >= buf.size()) return false;
+        size_t lineEnd = buf.find("\r\n", cur + 1);
+        if (lineEnd == std::string::npos) return false;
+
+        char prefix = buf[cur];
+        size_t next = lineEnd + 2;
+        switch (prefix) {
+            case '+' :
+            case '-' :
+            case ':' :
+                break;
+            case '$' : {
+                long long length = scanLength(buf, cur + 1, lineEnd);
+                if (length < -1) throw std::runtime_error("Malformed bulk length.");
+                if (length >= 0) {
+                    if (buf.size() - next < (size_t)length + 2) return false;
+                    next += length + 2;
+                }
+                break;
+            }
+            case '*' : {
+                long long count = scanLength(buf, cur + 1, lineEnd);
+                if (count < -1) throw std::runtime_error("Malformed array length.");
+                if (count > 0) {
+                    // The array completes once all of its elements have been scanned
+                    state.pending.push_back(count);
+                    cur = next;
+                    continue;
+                }
+                break;
+            }
+            default:
+                throw std::runtime_error("Unknown reply type.");
+        }
+        cur = next;
+
+        // One element done: close every array it was the last element of
+        while (!state.pending.empty() && --state.pending.back() == 0) {
+            state.pending.pop_back();
+        }
+        if (state.pending.empty()) {
+            end = cur;
+            state = ScanState();
+            return true;
+        }
+    }
+}
@@ -2,15 +2,31 @@
 #define RESPONSEPARSER_H
 
 #include <string>
+#include <vector>
 
 class ResponseParser {
 public:
     //Read from given socket and return parsed response as a string, return "" on failure
     static std::string parseResponse(int sockfd);
+
+    //Parse one reply from buf starting at pos, formatted like parseResponse(). Returns false and
+    //leaves pos untouched if the reply is not fully buffered yet; throws on malformed input
+    static bool parseBuffered(const std::string &buf, size_t &pos, std::string &reply);
+
+    //Progress through a partly received reply, kept between scanBuffered() calls
+    struct ScanState {
+        size_t offset = 0;              // scanned bytes, relative to the reply start
+        std::vector<long long> pending; // elements still expected by each open array
+    };
+
+    //Check whether the reply starting at pos is fully buffered without building any strings.
+    //Resumes from state, so each byte is scanned once however many reads the reply spans.
+    //Returns true and sets end when complete; throws on malformed input
+    static bool scanBuffered(const std::string &buf, size_t pos, ScanState &state, size_t &end);
 private:
 //Redis Serialization Protocol 2
     static std::string parseSimpleString(int sockfd);
-    static std::string parseSimpleErrors(int sockfd);
+    static std::string parseSimpleError(int sockfd);
     static std::string parseInteger(int sockfd);
     static std::string parseBulkString(int sockfd);
     static std::string parseArray(int sockfd); 
@@ -0,0 +1,50 @@
+/*
+Auto-pipelining throughput benchmark (make bench)
+    Drives RedisClient::execute() from 1..64 threads over one auto-pipelined
+    connection to FakeRedisServer and prints ops/s and commands per client write.
+    Pass a port to run against a real Redis server instead: make bench PORT=6379
+*/
+
+#include "FakeRedisServer.h"
+#include "RedisClient.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+
+int main(int argc, char *argv[]) {
+    const int perThread = 20000;
+
+    for (int threads : {1, 2, 4, 8, 16, 32, 64}) {
+        std::unique_ptr<FakeRedisServer> server;
+        int port;
+        if (argc > 1) {
+            port = std::atoi(argv[1]);
+        } else {
+            server.reset(new FakeRedisServer());
+            port = server->getPort();
+        }
+
+        RedisClient client("127.0.0.1", port);
+        if (!client.connectToServer() || !client.enableAutoPipelining()) return 1;
+
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; ++t) {
+            workers.emplace_back([&] {
+                for (int i = 0; i < perThread; ++i) client.execute({"ECHO", "value"});
+            });
+        }
+        for (auto &worker : workers) worker.join();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        client.disconnect();
+
+        long total = (long)threads * perThread;
+        std::printf("%2d threads: %9.0f ops/s", threads, total / seconds);
+        if (server) {
+            std::printf("  (%.1f commands per write)", (double)total / server->getRecvCalls());
+        }
+        std::printf("\n");
+    }
+    return 0;
+}
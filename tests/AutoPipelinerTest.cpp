@@ -0,0 +1,175 @@
+/*
+Auto-pipelining tests (make test)
+    Runs RedisClient::execute() against FakeRedisServer and checks that:
+        - replies reach the right caller when many threads submit at once,
+        - a reply split across packets does not stall other requests,
+        - a large array reply arriving over many reads is parsed in linear time,
+        - a reply that arrives before its request is fully sent fails that request,
+        - a connection dropped mid-reply fails the caller with an exception,
+        - later calls fail instead of waiting forever, and the dead loop is reported.
+*/
+
+#include "FakeRedisServer.h"
+#include "RedisClient.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+
+static int failures = 0;
+
+#define CHECK(cond)                                                             \
+    do {                                                                        \
+        if (!(cond)) {                                                          \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": CHECK failed: " #cond \
+                      << "\n";                                                  \
+            ++failures;                                                         \
+        }                                                                       \
+    } while (0)
+
+static bool throwsRuntimeError(RedisClient &client, const std::vector<std::string> &args) {
+    try {
+        client.execute(args);
+    } catch (const std::runtime_error &) {
+        return true;
+    }
+    return false;
+}
+
+static void testConcurrentOrdering() {
+    FakeRedisServer server;
+    RedisClient client("127.0.0.1", server.getPort());
+    CHECK(client.connectToServer());
+    CHECK(client.execute({"ECHO", "before"}) == "before");
+    CHECK(client.enableAutoPipelining());
+
+    const int threads = 16, perThread = 2000;
+    std::atomic<int> mismatches(0);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            for (int i = 0; i < perThread; ++i) {
+                std::string value = std::to_string(t) + "-" + std::to_string(i);
+                if (client.execute({"ECHO", value}) != value) ++mismatches;
+            }
+        });
+    }
+    for (auto &worker : workers) worker.join();
+
+    CHECK(mismatches == 0);
+    // Concurrent submissions must be coalesced into fewer writes than commands
+    CHECK(server.getRecvCalls() < threads * perThread);
+    client.disconnect();
+}
+
+static void testSplitReplyDoesNotBlockLoop() {
+    std::atomic<bool> fastSentDuringSlowReply(false);
+    FakeRedisServer server([&](int fd, const std::vector<std::string> &args) {
+        if (args.back() == "slow") {
+            FakeRedisServer::sendAll(fd, "$4\r\nsl");
+            std::this_thread::sleep_for(std::chrono::milliseconds(300));
+            // A loop stuck on the half-read reply could not have flushed "fast" yet
+            char pending[256];
+            ssize_t n = recv(fd, pending, sizeof(pending), MSG_PEEK | MSG_DONTWAIT);
+            if (n > 0 && std::string(pending, n).find("fast") != std::string::npos) {
+                fastSentDuringSlowReply = true;
+            }
+            return FakeRedisServer::sendAll(fd, "ow\r\n");
+        }
+        return FakeRedisServer::echoLast(fd, args);
+    });
+    RedisClient client("127.0.0.1", server.getPort());
+    CHECK(client.connectToServer());
+    CHECK(client.enableAutoPipelining());
+
+    std::string slowReply;
+    std::thread slow([&] { slowReply = client.execute({"ECHO", "slow"}); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    // Replies stay in order, so "fast" still completes after "slow"
+    CHECK(client.execute({"ECHO", "fast"}) == "fast");
+    slow.join();
+
+    CHECK(slowReply == "slow");
+    CHECK(fastSentDuringSlowReply);
+    client.disconnect();
+}
+
+static void testLargeArraySplitAcrossPackets() {
+    const int elements = 800000;
+    FakeRedisServer server([&](int fd, const std::vector<std::string> &) {
+        std::string reply = "*" + std::to_string(elements) + "\r\n";
+        for (int i = 0; i < elements; ++i) {
+            std::string value = std::to_string(i);
+            reply += "$" + std::to_string(value.size()) + "\r\n" + value + "\r\n";
+        }
+        // Small writes so the client sees the reply over many reads
+        for (size_t off = 0; off < reply.size(); off += 1024) {
+            if (!FakeRedisServer::sendAll(fd, reply.substr(off, 1024))) return false;
+        }
+        return true;
+    });
+    RedisClient client("127.0.0.1", server.getPort());
+    CHECK(client.connectToServer());
+    CHECK(client.enableAutoPipelining());
+
+    auto start = std::chrono::steady_clock::now();
+    std::string reply = client.execute({"LRANGE", "list", "0", "-1"});
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    CHECK(std::count(reply.begin(), reply.end(), '\n') == elements - 1);
+    CHECK(reply.compare(0, 4, "0\n1\n") == 0);
+    CHECK(reply.size() > 6 && reply.compare(reply.size() - 6, 6, "799999") == 0);
+    // Re-parsing the partial array on every read makes this take several seconds
+    CHECK(elapsed < std::chrono::seconds(2));
+    client.disconnect();
+}
+
+static void testReplyBeforeRequestFullySent() {
+    // Like Redis rejecting an oversized bulk: answer as soon as the first bytes arrive
+    FakeRedisServer server([](int fd) {
+        char chunk[4096];
+        if (recv(fd, chunk, sizeof(chunk), 0) <= 0) return;
+        FakeRedisServer::sendAll(fd, "-ERR Protocol error: invalid bulk length\r\n");
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    });
+    RedisClient client("127.0.0.1", server.getPort());
+    CHECK(client.connectToServer());
+    CHECK(client.enableAutoPipelining());
+
+    std::string huge(64 * 1024 * 1024, 'x');
+    CHECK(throwsRuntimeError(client, {"SET", "key", huge}));
+    client.disconnect();
+}
+
+static void testConnectionDropMidReply() {
+    FakeRedisServer server([](int fd, const std::vector<std::string> &) {
+        FakeRedisServer::sendAll(fd, "$5\r\nab");
+        return false; // close with the bulk string unfinished
+    });
+    RedisClient client("127.0.0.1", server.getPort());
+    CHECK(client.connectToServer());
+    CHECK(client.enableAutoPipelining());
+
+    CHECK(throwsRuntimeError(client, {"GET", "key"}));
+    CHECK(throwsRuntimeError(client, {"GET", "key"}));
+
+    // The dead loop is reported, not silently kept; a fresh connection is needed
+    CHECK(!client.enableAutoPipelining());
+    client.disconnect();
+}
+
+int main() {
+    testConcurrentOrdering();
+    testSplitReplyDoesNotBlockLoop();
+    testLargeArraySplitAcrossPackets();
+    testReplyBeforeRequestFullySent();
+    testConnectionDropMidReply();
+
+    if (failures) {
+        std::cerr << failures << " check(s) failed\n";
+        return 1;
+    }
+    std::cout << "All auto-pipelining tests passed\n";
+    return 0;
+}
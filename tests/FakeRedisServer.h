@@ -0,0 +1,137 @@
+#ifndef FAKE_REDIS_SERVER_H
+#define FAKE_REDIS_SERVER_H
+
+/*
+Minimal in-process RESP server for the auto-pipelining tests and benchmark.
+    Listens on an ephemeral loopback port and serves one connection. Every complete
+    command array is handed to a handler that writes the raw reply bytes; the default
+    handler echoes the last argument back as a bulk string. Tests that need to act
+    before a command is complete can take over the whole connection with a Session.
+*/
+
+#include <arpa/inet.h>
+#include <atomic>
+#include <functional>
+#include <netinet/in.h>
+#include <string>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+class FakeRedisServer {
+public:
+    // Return false from the handler to close the connection after writing
+    using Handler = std::function<bool(int clientfd, const std::vector<std::string> &args)>;
+
+    // Drive the accepted connection directly; it is closed when the session returns
+    using Session = std::function<void(int clientfd)>;
+
+    explicit FakeRedisServer(Handler handler = echoLast)
+        : handler(handler), session([this](int clientfd) { serveCommands(clientfd); }) {
+        listenOnLoopback();
+    }
+
+    explicit FakeRedisServer(Session session) : session(session) {
+        listenOnLoopback();
+    }
+
+    ~FakeRedisServer() {
+        shutdown(listenfd, SHUT_RDWR);
+        close(listenfd);
+        serverThread.join();
+    }
+
+    int getPort() const { return port; }
+    // Number of recv() calls that returned data, i.e. client writes as seen by the server
+    long getRecvCalls() const { return recvCalls; }
+
+    static bool echoLast(int clientfd, const std::vector<std::string> &args) {
+        const std::string &value = args.back();
+        std::string reply = "$" + std::to_string(value.size()) + "\r\n" + value + "\r\n";
+        return sendAll(clientfd, reply);
+    }
+
+    static bool sendAll(int fd, const std::string &data) {
+        size_t sent = 0;
+        while (sent < data.size()) {
+            ssize_t n = send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+            if (n <= 0) return false;
+            sent += n;
+        }
+        return true;
+    }
+
+private:
+    void listenOnLoopback() {
+        listenfd = socket(AF_INET, SOCK_STREAM, 0);
+        int on = 1;
+        setsockopt(listenfd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        bind(listenfd, (sockaddr *)&addr, sizeof(addr));
+        socklen_t len = sizeof(addr);
+        getsockname(listenfd, (sockaddr *)&addr, &len);
+        port = ntohs(addr.sin_port);
+        listen(listenfd, 1);
+        serverThread = std::thread(&FakeRedisServer::serve, this);
+    }
+
+    void serve() {
+        int clientfd = accept(listenfd, nullptr, nullptr);
+        if (clientfd < 0) return;
+        session(clientfd);
+        close(clientfd);
+    }
+
+    void serveCommands(int clientfd) {
+        std::string buffer;
+        char chunk[64 * 1024];
+        bool open = true;
+        while (open) {
+            ssize_t n = recv(clientfd, chunk, sizeof(chunk), 0);
+            if (n <= 0) break;
+            ++recvCalls;
+            buffer.append(chunk, n);
+
+            size_t pos = 0;
+            std::vector<std::string> args;
+            while (open && parseCommand(buffer, pos, args)) {
+                open = handler(clientfd, args);
+            }
+            buffer.erase(0, pos);
+        }
+    }
+
+    // Parse one "*N\r\n$len\r\narg\r\n..." command; false if it is not fully buffered
+    static bool parseCommand(const std::string &buf, size_t &pos, std::vector<std::string> &args) {
+        size_t cur = pos;
+        size_t end = buf.find("\r\n", cur);
+        if (end == std::string::npos) return false;
+        int count = std::stoi(buf.substr(cur + 1, end - cur - 1));
+        cur = end + 2;
+
+        args.clear();
+        for (int i = 0; i < count; ++i) {
+            end = buf.find("\r\n", cur);
+            if (end == std::string::npos) return false;
+            size_t len = std::stoul(buf.substr(cur + 1, end - cur - 1));
+            cur = end + 2;
+            if (buf.size() < cur + len + 2) return false;
+            args.push_back(buf.substr(cur, len));
+            cur += len + 2;
+        }
+        pos = cur;
+        return true;
+    }
+
+    Handler handler;
+    Session session;
+    int listenfd = -1;
+    int port = 0;
+    std::atomic<long> recvCalls{0};
+    std::thread serverThread;
+};
+
+#endif //FAKE_REDIS_SERVER_H